@@ -10,20 +10,38 @@
 //	--displays the cost and path from every vertex to every other vertex in a 
 //	  specific format
 //	--can output one particular path in detail 
-//	--reads data from a file
+//	--reads data from a file (or any other input stream)
 //	--inserts an edge into a graph, replacing the previous edge that existed 
 //	  between the two vertices
+//	--can relabel its vertices (BFS, Reverse Cuthill-McKee or degree order)
+//	  while keeping the original vertex numbers for all input and output;
+//	  within the 100 vertex limit this does not speed up findShortestPath()
+//	--copies share the vertex data, edge lists and path table with the 
+//	  original until one of them changes, so copying a graph is O(1)
+//	--finds the k shortest loopless paths between two vertices (Yen's 
+//	  algorithm), or alternative routes that share few edges with each other
 // ASSUMPTIONS:
 //	--text file to be read by the program contains properly formatted info
-//	  the graph can contain no more than 100 vertices
+//	  the graph can contain no more than 100 vertices; reading stops at the 
+//	  first malformed line and leaves the stream in a failed state
 //	--user is responsible to call findShortestPath() in order to "update"
 //	  the look of the grapth's output, if the insertEdge() or removeEdge()
 //	  were called after the original shortest path search occurred.
-//	--the graph contains no negative values of weights or vertices
+//	--the graph contains no negative values of weights or vertices; an edge
+//	  with a negative weight is ignored
+//	--a second edge between the same two vertices replaces the first, also
+//	  in the input file, where the last line wins
+//	--distances that cannot be reached stay INT_MAX in the table
 //-----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <queue>
+#include <set>
 #include <string> 
 #include "Graph.h"
 using namespace std;
@@ -31,113 +49,234 @@ using namespace std;
 //-------------------------------Default Constructor-----------------------
 // Preconditions:none
 // Postconditions: a new Graph object is created with size '0'; the adjecency
-// list and a table get initialized;
+// list and a table get allocated when the graph is built and searched
 Graph::Graph()
 {
 	size = 0;
-	this->initializeAdjList();
-	this->initializeTable();
 }
 
+//--------------------------------Copy Constructor----------------------------
+// makes a copy of a graph that shares the source's adjacency list and table 
+// until either graph changes
+// Preconditions: srcGraph must be allocated in memory
+// Postconditions: srcGrapth is copied into this graph (as well as its table)
+Graph::Graph(const Graph &srcGraph) : 
+	size(srcGraph.size), adj(srcGraph.adj), paths(srcGraph.paths)
+{
+}
 
-//------------------------------  initializeTable  ----------------------------
-// Initializes the Table (2D array) to default values
-// Preconditions: the Graph object must be allocated
-// Postconditions: the Graph's Table is properly initialized to default values
-void Graph::initializeTable()
+//--------------------------------Move Constructor----------------------------
+// takes over the adjacency list and table of a graph that is going away
+// Preconditions: srcGraph must be allocated in memory
+// Postconditions: this graph holds srcGraph's contents; srcGraph is empty
+Graph::Graph(Graph &&srcGraph) noexcept : 
+	size(srcGraph.size), adj(std::move(srcGraph.adj)), 
+	paths(std::move(srcGraph.paths))
 {
-	for (int src = 1; src <= size; src++)
+	srcGraph.size = 0;
+}
+
+//------------------------------------  =  ------------------------------------
+// assigns srcGraph to *this, sharing its adjacency list and table until 
+// either graph changes
+// Preconditions: srcGraph must be allocated in memory
+// Postconditions: srcGraph is copied into *this
+Graph & Graph::operator=(const Graph &srcGraph)
+{
+	this->size = srcGraph.size;
+	this->adj = srcGraph.adj;
+	this->paths = srcGraph.paths;
+	return *this;
+}
+
+//------------------------------------  =  ------------------------------------
+// moves the contents of a graph that is going away into *this
+// Preconditions: srcGraph must be allocated in memory
+// Postconditions: *this holds srcGraph's contents; srcGraph is empty
+Graph & Graph::operator=(Graph &&srcGraph) noexcept
+{
+	if (this != &srcGraph)
 	{
-		for (int v = 1; v <= size; v++)
-		{
-			T[src][v].dist = INT_MAX;
-			T[src][v].path = 0;
-			T[src][v].visited = false;
-		}
+		this->size = srcGraph.size;
+		this->adj = std::move(srcGraph.adj);
+		this->paths = std::move(srcGraph.paths);
+		srcGraph.size = 0;
+	}
+	return *this;
+}
+
+//------------------------------  EdgeList  -----------------------------------
+// Preconditions: none
+// Postconditions: an empty list of edges is created
+Graph::EdgeList::EdgeList()
+{
+	head = NULL;
+}
+
+//------------------------------  EdgeList  -----------------------------------
+// makes a deep copy of a list of edges
+// Preconditions: srcList must be allocated in memory
+// Postconditions: every EdgeNode of srcList is copied, in the same order
+Graph::EdgeList::EdgeList(const EdgeList &srcList)
+{
+	EdgeNode **link = &head;
+	for (EdgeNode *orig = srcList.head; orig != NULL; orig = orig->nextEdge)
+	{
+		*link = new EdgeNode;
+		(*link)->adjVertex = orig->adjVertex;
+		(*link)->weight = orig->weight;
+		link = &(*link)->nextEdge;
+	}
+	*link = NULL;
+}
+
+//------------------------------  ~EdgeList  ----------------------------------
+// Preconditions: none
+// Postconditions: every EdgeNode of the list is deallocated
+Graph::EdgeList::~EdgeList()
+{
+	while (head != NULL)
+	{
+		EdgeNode *temp = head;
+		head = head->nextEdge;
+		delete temp;
+	}
+}
+
+//------------------------------  AdjList  ------------------------------------
+// Preconditions: none
+// Postconditions: no vertex has edges or data and every vertex subscript maps
+// to itself (the numbering read from the input file)
+Graph::AdjList::AdjList()
+{
+	for (int i = 0; i < MAX_VERTICES; i++)
+	{
+		toInternal[i] = i;
+		toOriginal[i] = i;
 	}
 }
 
-//------------------------------  initializeAdjList  --------------------------
-// Initializes the Graph object (represented by an adjacency list) to the
-// default values
+//------------------------------  isShared  -----------------------------------
+// Tells whether a block is also referenced by another copy of the graph
+// Preconditions: none
+// Postconditions: returns false if useCount says this graph is the block's 
+// only owner
+bool Graph::isShared(long useCount)
+{
+	if (useCount == 1)
+	{
+		// the last other owner released the block; see its writes too
+		atomic_thread_fence(memory_order_acquire);
+		return false;
+	}
+	return true;
+}
+
+//------------------------------  ownAdjList  ---------------------------------
+// Gives this graph its own vertex array before it gets changed; the edge 
+// lists and vertex data stay shared
 // Preconditions: the Graph object must be allocated
-// Postconditions: the Graph's adjacency list is properly initialized to 
-// default values (edgeHead of a linked list at vertex[i] is initialiazed to 
-// NULL). 
-void Graph::initializeAdjList()
+// Postconditions: the adjacency list is referenced by this graph only
+Graph::AdjList & Graph::ownAdjList()
 {
-	for (int i = 1; i < MAX_VERTICES; i++)
+	if (!adj)
+	{
+		adj = make_shared<AdjList>();
+	}
+	else if (isShared(adj.use_count()))
 	{
-		vertices[i].edgeHead = NULL;
+		adj = make_shared<AdjList>(*adj);
 	}
+	return *adj;
 }
 
-//--------------------------------Copy Constructor----------------------------
-// makes a deep copy of a graph
-// Preconditions: srcGraph must be allocated in memory
-// Postconditions: srcGrapth is copied into this graph 9as well as its table)
-Graph::Graph(const Graph &srcGraph)
+//------------------------------  ownEdges  -----------------------------------
+// Gives this graph its own copy of the edges leaving vertex v before they get
+// changed
+// Preconditions: v is a subscript within the graph's size limits
+// Postconditions: the list of edges of v is referenced by this graph only
+Graph::EdgeList & Graph::ownEdges(int v)
 {
-	for (int index = 1; index <= srcGraph.size; index++)
+	shared_ptr<EdgeList> &edges = ownAdjList().vertices[v].edges;
+	if (!edges)
 	{
-		this->size = srcGraph.size;
-		this->vertices[index].data = srcGraph.vertices[index].data;
-		EdgeNode *orig = srcGraph.vertices[index].edgeHead;
-		if (orig == NULL)
-		{
-			this->vertices[index].edgeHead = NULL;
-		}
-		else
-		{
-			this->vertices[index].edgeHead = new EdgeNode;
-			this->vertices[index].edgeHead->adjVertex = srcGraph.vertices[index].edgeHead->adjVertex;
-			this->vertices[index].edgeHead->weight = srcGraph.vertices[index].edgeHead->weight;
-			EdgeNode *cur = this->vertices[index].edgeHead;
-			orig = orig->nextEdge;
-			while (orig != NULL)
-			{
-				cur->nextEdge = new EdgeNode;
-				cur->nextEdge->adjVertex = orig->adjVertex;
-				cur->nextEdge->weight = orig->weight;
-				cur = cur->nextEdge;
-				orig = orig->nextEdge;
-			}
-			cur->nextEdge = NULL;
-		}
-		for (int dest = 1; dest <= srcGraph.size; dest++)
+		edges = make_shared<EdgeList>();
+	}
+	else if (isShared(edges.use_count()))
+	{
+		edges = make_shared<EdgeList>(*edges);
+	}
+	return *edges;
+}
+
+//------------------------------  firstEdge  ----------------------------------
+// Preconditions: v is a subscript within the graph's size limits
+// Postconditions: returns the head of the list of edges leaving v, or NULL 
+Graph::EdgeNode * Graph::firstEdge(int v) const
+{
+	const shared_ptr<EdgeList> &edges = adj->vertices[v].edges;
+	return edges ? edges->head : NULL;
+}
+
+//------------------------------  initializeTable  ----------------------------
+// Initializes the Table (2D array) to default values
+// Preconditions: the Graph object must be allocated
+// Postconditions: the Graph's Table is referenced by this graph only and is 
+// properly initialized to default values
+void Graph::initializeTable()
+{
+	if (!paths || isShared(paths.use_count()))
+	{
+		// every entry is overwritten below, so the old table is not copied
+		paths = shared_ptr<PathTable>(new PathTable);
+	}
+	for (int src = 1; src <= size; src++)
+	{
+		for (int v = 1; v <= size; v++)
 		{
-			this->T[index][dest].path = srcGraph.T[index][dest].path;
-			this->T[index][dest].dist = srcGraph.T[index][dest].dist;
-			this->T[index][dest].visited = srcGraph.T[index][dest].visited;
+			paths->T[src][v].dist = INT_MAX;
+			paths->T[src][v].path = 0;
+			paths->T[src][v].visited = false;
 		}
 	}
 }
 
 //-------------------------------- buildGraph ---------------------------------
-// Builds a graph by reading data from an ifstream
+// Builds a graph by reading data from an istream
 // Preconditions:  infile has been successfully opened and the file contains
 // properly formated data (according to the program specs)
-// Postconditions: One graph is read from infile and stored in the object
-void Graph::buildGraph(ifstream& infile) {
+// Postconditions: One graph is read from infile and stored in the object; if
+// the vertex count is out of range the graph is left empty and infile fails,
+// other malformed data ends the list of edges
+void Graph::buildGraph(istream& infile) {
 
-	infile >> size;                          // data member stores array size
-	if (infile.eof())
+	this->clear();
+	int count = 0;
+	infile >> count;
+	if (!infile)
 		return;
+	if (count < 0 || count >= MAX_VERTICES)
+	{
+		infile.setstate(ios::failbit);
+		return;
+	}
+	size = count;                            // data member stores array size
 	infile.ignore();                         // throw away '\n' go to next line
+	adj = make_shared<AdjList>();            // edges use the file's numbering
+	paths.reset();
 	string vertexName;
 	// get descriptions of vertices
 	for (int v = 1; v <= size; v++)
 	{
 		getline(infile, vertexName, '\n');
-		GraphData *newData = new GraphData(vertexName);
-		vertices[v].data = newData;         // store appropriately
+		adj->vertices[v].data = make_shared<GraphData>(vertexName);
 	}
 	// fill cost edge array
 	int src = 1, dest = 1, cost = 1;
 	for (;;)
 	{
 		infile >> src >> dest >> cost;
-		if (src == 0 || infile.eof())
+		if (infile.fail() || src == 0)
 			break;
 		insertEdge(src, dest, cost);
 	}
@@ -147,24 +286,26 @@ void Graph::buildGraph(ifstream& infile) {
 // Inserts an edge into a graph
 // Preconditions: Grapth object is allocated in memory; src is within the size 
 // limits of a current object
-// Postconditions: an edge is inserted into a graph if its source is within
-// size limits, replacing any previous edge between the vertices
+// Postconditions: an edge is inserted into a graph if its source and 
+// destination are within size limits and its weight is not negative, 
+// replacing any previous edge between the vertices
 void Graph::insertEdge(int src, int dest, int cost)
 {
-	EdgeNode *edgeN = new EdgeNode;
-	edgeN->adjVertex = dest;
-	edgeN->weight = cost;
-	if (src >= 1 && src <= size)
+	if (src >= 1 && src <= size && dest >= 1 && dest <= size && cost >= 0)
 	{
-		if (vertices[src].edgeHead == NULL ||
-			edgeN->adjVertex <= vertices[src].edgeHead->adjVertex)
+		removeEdge(src, dest);
+		EdgeList &edges = ownEdges(adj->toInternal[src]);
+		EdgeNode *edgeN = new EdgeNode;
+		edgeN->adjVertex = adj->toInternal[dest];
+		edgeN->weight = cost;
+		if (edges.head == NULL || edgeN->adjVertex <= edges.head->adjVertex)
 		{
-			edgeN->nextEdge = vertices[src].edgeHead;
-			vertices[src].edgeHead = edgeN;
+			edgeN->nextEdge = edges.head;
+			edges.head = edgeN;
 		}
 		else
 		{
-			EdgeNode *cur = vertices[src].edgeHead;
+			EdgeNode *cur = edges.head;
 			while (cur->nextEdge != NULL &&
 				cur->nextEdge->adjVertex < edgeN->adjVertex)
 			{
@@ -183,28 +324,32 @@ void Graph::insertEdge(int src, int dest, int cost)
 // Postconditions: the edge is removed from the graph
 void Graph::removeEdge(int src, int dest)
 {
-	if (src >= 1 && src <= size)
+	if (src >= 1 && src <= size && dest >= 1 && dest <= size)
 	{
-		while (this->vertices[src].edgeHead != NULL &&
-			this->vertices[src].edgeHead->adjVertex == dest)
+		src = adj->toInternal[src];
+		dest = adj->toInternal[dest];
+		EdgeNode *cur = firstEdge(src);
+		while (cur != NULL && cur->adjVertex != dest)
 		{
-			EdgeNode * temp = this->vertices[src].edgeHead;
-			this->vertices[src].edgeHead = this->vertices[src].edgeHead->nextEdge;
-			delete temp;
+			cur = cur->nextEdge;
 		}
-		if (this->vertices[src].edgeHead == NULL)
+		if (cur == NULL)
 		{
-			return;
+			return;                         // nothing to remove, keep sharing
 		}
-		for (EdgeNode *cur = this->vertices[src].edgeHead;
-			cur->nextEdge != NULL; cur = cur->nextEdge)
+		EdgeNode **link = &ownEdges(src).head;
+		while (*link != NULL)
 		{
-			while (cur->nextEdge != NULL && cur->nextEdge->adjVertex == dest)
+			if ((*link)->adjVertex == dest)
 			{
-				EdgeNode * temp = cur->nextEdge;
-				cur->nextEdge = temp->nextEdge;
+				EdgeNode *temp = *link;
+				*link = temp->nextEdge;
 				delete temp;
 			}
+			else
+			{
+				link = &(*link)->nextEdge;
+			}
 		}
 	}
 }
@@ -218,6 +363,7 @@ void Graph::removeEdge(int src, int dest)
 void Graph::findShortestPath()
 {
 	this->initializeTable();
+	Table (*T)[MAX_VERTICES] = paths->T;
 	int src, minIndex;
 	for (int vertex = 1; vertex <= size; vertex++)
 	{
@@ -236,13 +382,17 @@ void Graph::findShortestPath()
 					minIndex = i;
 				}
 			}
+			if (minDist == INT_MAX)
+			{
+				break;                      // the rest cannot be reached
+			}
 			T[src][minIndex].visited = true;
-			EdgeNode *cur = vertices[minIndex].edgeHead;
-			while (cur != NULL && vertices[src].edgeHead != NULL)
+			EdgeNode *cur = firstEdge(minIndex);
+			while (cur != NULL && firstEdge(src) != NULL)
 			{
 				if (T[src][cur->adjVertex].visited == false )
 				{
-					if (minDist + cur->weight < T[src][cur->adjVertex].dist)
+					if (cur->weight < T[src][cur->adjVertex].dist - minDist)
 					{
 						T[src][cur->adjVertex].dist = cur->weight + minDist;
 						T[src][cur->adjVertex].path = minIndex;
@@ -254,6 +404,580 @@ void Graph::findShortestPath()
 	}
 }
 
+//-----------------------------  getDistance  --------------------------------
+// Preconditions: findShortestPath() has been called since the graph last 
+// changed
+// Postconditions: returns the distance of the shortest path from src to dest,
+// INT_MAX if dest cannot be reached, or -1 if src or dest is not within the 
+// graph's size limits or no search was made
+int Graph::getDistance(int src, int dest) const
+{
+	if (src < 1 || src > size || dest < 1 || dest > size || !paths)
+	{
+		return -1;
+	}
+	return paths->T[adj->toInternal[src]][adj->toInternal[dest]].dist;
+}
+
+//-----------------------------  getPath  -------------------------------------
+// Preconditions: findShortestPath() has been called since the graph last 
+// changed
+// Postconditions: path holds the vertex numbers of the shortest path from src
+// to dest (empty if there is none); returns the number of vertices
+int Graph::getPath(int src, int dest, vector<int> &path) const
+{
+	path.clear();
+	int dist = getDistance(src, dest);
+	if (dist < 0 || dist == INT_MAX)
+	{
+		return 0;
+	}
+	src = adj->toInternal[src];
+	for (int v = adj->toInternal[dest]; v != -1; v = paths->T[src][v].path)
+	{
+		path.push_back(adj->toOriginal[v]);
+	}
+	reverse(path.begin(), path.end());
+	return (int)path.size();
+}
+
+//---------------------------- reorderVertices  -------------------------------
+// Relabels the vertices internally so that vertices that are relaxed together
+// by findShortestPath() are stored close together in memory.
+// Within MAX_VERTICES this does not make findShortestPath() faster.
+// Preconditions: the graph object is allocated and properly initialized
+// Postconditions: the adjacency list and vertex data are permuted in the 
+// requested order; all methods keep taking and displaying the original vertex
+// numbers. The table is dropped, as before the first search, so 
+// findShortestPath() must be called again before displaying or querying.
+void Graph::reorderVertices(VertexOrder how)
+{
+	int order[MAX_VERTICES];
+	int degree[MAX_VERTICES];
+	for (int v = 1; v <= size; v++)
+	{
+		degree[v] = 0;
+	}
+	for (int v = 1; v <= size; v++)
+	{
+		for (EdgeNode *cur = firstEdge(v); cur != NULL; 
+			cur = cur->nextEdge)
+		{
+			degree[v]++;
+			degree[cur->adjVertex]++;
+		}
+	}
+	switch (how)
+	{
+	case BFS_ORDER:
+		computeBFSOrder(order, degree, false);
+		break;
+	case RCM_ORDER:
+		computeBFSOrder(order, degree, true);
+		break;
+	case DEGREE_ORDER:
+		computeDegreeOrder(order, degree);
+		break;
+	default:
+		// subscript of every original vertex, i.e. undo earlier reordering
+		for (int v = 1; v <= size; v++)
+		{
+			order[v] = adj->toInternal[v];
+		}
+		break;
+	}
+	applyOrder(order);
+	paths.reset();
+}
+
+//------------------------- findKShortestPaths  ------------------------------
+// Finds up to k loopless paths from src to dest in increasing order of 
+// distance (Yen's algorithm)
+// Preconditions: the graph object is allocated and properly initialized
+// Postconditions: routes holds the paths found as vertex numbers from src to
+// dest, and dists their distances; returns the number of paths found (0 if 
+// src or dest is not within the graph's size limits)
+int Graph::findKShortestPaths(int src, int dest, int k,
+	vector<vector<int> > &routes, vector<int> &dists) const
+{
+	return findRoutes(src, dest, k, k, 1.0, routes, dists);
+}
+
+//------------------------- findAlternativeRoutes  ---------------------------
+// Finds up to k short loopless paths from src to dest that differ from each
+// other: a path is skipped if more than maxOverlap (0.0 to 1.0) of its edges
+// are also used by a shorter route that was kept. At most k times the graph's
+// size paths are examined.
+// Preconditions: the graph object is allocated and properly initialized
+// Postconditions: routes holds the routes found as vertex numbers from src to
+// dest, and dists their distances; returns the number of routes
+int Graph::findAlternativeRoutes(int src, int dest, int k, double maxOverlap,
+	vector<vector<int> > &routes, vector<int> &dists) const
+{
+	long long examined = (long long)k * size;  // k * size could overflow
+	if (examined > INT_MAX)
+	{
+		examined = INT_MAX;
+	}
+	return findRoutes(src, dest, k, (int)examined, maxOverlap, routes, dists);
+}
+
+//------------------------------  findRoutes  ---------------------------------
+// Runs Yen's algorithm from src to dest, examining up to the given number of 
+// shortest paths and keeping the ones whose overlap with the routes kept 
+// before is at most maxOverlap, until wanted routes are kept
+// Preconditions: the graph object is allocated and properly initialized
+// Postconditions: routes and dists hold the routes kept, with original vertex
+// numbers; returns the number of routes kept
+int Graph::findRoutes(int src, int dest, int wanted, int examined, 
+	double maxOverlap, vector<vector<int> > &routes, vector<int> &dists) const
+{
+	routes.clear();
+	dists.clear();
+	if (src < 1 || src > size || dest < 1 || dest > size || wanted < 1)
+	{
+		return 0;
+	}
+	src = adj->toInternal[src];
+	dest = adj->toInternal[dest];
+	SpurSearch search;
+	findDistancesTo(search, dest);
+	vector<Route> found;					// shortest paths so far, in order
+	vector<Route> candidates;				// deviations, a min-heap by dist
+	set<vector<int> > seen;					// every path made a candidate
+	priority_queue<int> best;				// lowest candidate distances, at
+											// most examined - 1 of them
+	vector<int> kept;						// subscripts into found
+	while ((int)kept.size() < wanted && (int)found.size() < examined)
+	{
+		Route next;
+		if (found.empty())
+		{
+			if (search.toDest[src] == INT_MAX)
+			{
+				break;
+			}
+			for (int v = src; v != -1; v = search.next[v])
+			{
+				next.path.push_back(v);
+			}
+			next.dist = search.toDest[src];
+		}
+		else
+		{
+			// every prefix of the last path found is the root of a deviation
+			const vector<int> &last = found.back().path;
+			int rootDist = 0;
+			for (size_t j = 0; j + 1 < last.size(); j++)
+			{
+				if (j > 0)
+				{
+					rootDist += edgeWeight(last[j - 1], last[j]);
+				}
+				// no more than examined - 1 candidates are ever taken, so one
+				// that is not shorter than all of the best ones is useless
+				int bound = INT_MAX;
+				if (!best.empty() && (int)best.size() >= examined - 1)
+				{
+					bound = best.top();
+				}
+				if (rootDist >= bound)
+				{
+					break;                  // longer roots cannot do better
+				}
+				if ((long long)rootDist + search.toDest[last[j]] >= bound)
+				{
+					continue;
+				}
+				for (int v = 1; v <= size; v++)
+				{
+					search.removed[v] = false;
+					search.cut[v] = false;
+				}
+				for (size_t i = 0; i < j; i++)
+				{
+					search.removed[last[i]] = true;
+				}
+				for (size_t f = 0; f < found.size(); f++)
+				{
+					const vector<int> &path = found[f].path;
+					if (path.size() > j + 1 &&
+						equal(last.begin(), last.begin() + j + 1, path.begin()))
+					{
+						search.cut[path[j + 1]] = true;
+					}
+				}
+				search.spurRoute.assign(last.begin(), last.begin() + j);
+				int spurDist;
+				if (findSpurPath(search, last[j], dest, rootDist, bound, 
+					search.spurRoute, spurDist) && 
+					seen.insert(search.spurRoute).second)
+				{
+					Route cand;
+					cand.dist = rootDist + spurDist;
+					cand.path = search.spurRoute;
+					candidates.push_back(cand);
+					push_heap(candidates.begin(), candidates.end(), isLonger);
+					best.push(cand.dist);
+					if ((int)best.size() > examined - 1)
+					{
+						best.pop();
+					}
+				}
+			}
+			if (candidates.empty())
+			{
+				break;
+			}
+			pop_heap(candidates.begin(), candidates.end(), isLonger);
+			next = candidates.back();
+			candidates.pop_back();
+		}
+		found.push_back(next);
+		bool differs = true;
+		int edges = (int)next.path.size() - 1;
+		for (size_t r = 0; differs && r < kept.size(); r++)
+		{
+			differs = sharedEdges(next.path, found[kept[r]].path) <= 
+				maxOverlap * edges;
+		}
+		if (differs)
+		{
+			kept.push_back((int)found.size() - 1);
+			vector<int> route;
+			for (size_t i = 0; i < next.path.size(); i++)
+			{
+				route.push_back(adj->toOriginal[next.path[i]]);
+			}
+			routes.push_back(route);
+			dists.push_back(next.dist);
+		}
+	}
+	return (int)routes.size();
+}
+
+//------------------------------  findDistancesTo  ----------------------------
+// Dijkstra's algorithm over the reversed edges, from dest
+// Preconditions: dest is a subscript within the graph's size limits
+// Postconditions: search.toDest and search.next describe the shortest paths 
+// from every vertex to dest
+void Graph::findDistancesTo(SpurSearch &search, int dest) const
+{
+	// group the edges by the vertex they lead to (counting sort)
+	int fill[MAX_VERTICES + 1];
+	for (int v = 0; v <= size + 1; v++)
+	{
+		search.inStart[v] = 0;
+	}
+	for (int u = 1; u <= size; u++)
+	{
+		for (EdgeNode *cur = firstEdge(u); cur != NULL; cur = cur->nextEdge)
+		{
+			search.inStart[cur->adjVertex + 1]++;
+		}
+	}
+	for (int v = 1; v <= size + 1; v++)
+	{
+		search.inStart[v] += search.inStart[v - 1];
+		fill[v] = search.inStart[v];
+	}
+	search.in.resize(search.inStart[size + 1]);
+	for (int u = 1; u <= size; u++)
+	{
+		for (EdgeNode *cur = firstEdge(u); cur != NULL; cur = cur->nextEdge)
+		{
+			search.in[fill[cur->adjVertex]++] = make_pair(u, cur->weight);
+		}
+	}
+
+	for (int v = 1; v <= size; v++)
+	{
+		search.toDest[v] = INT_MAX;
+		search.visited[v] = false;
+	}
+	search.heap.clear();
+	search.toDest[dest] = 0;
+	search.next[dest] = -1;
+	search.heap.push_back(make_pair(0, dest));
+	while (!search.heap.empty())
+	{
+		pop_heap(search.heap.begin(), search.heap.end(), 
+			greater<pair<int, int> >());
+		int v = search.heap.back().second;
+		search.heap.pop_back();
+		if (search.visited[v])
+		{
+			continue;
+		}
+		search.visited[v] = true;
+		for (int i = search.inStart[v]; i < search.inStart[v + 1]; i++)
+		{
+			int u = search.in[i].first;
+			long long newDist = (long long)search.toDest[v] + search.in[i].second;
+			if (search.visited[u] || newDist >= search.toDest[u])
+			{
+				continue;
+			}
+			search.toDest[u] = (int)newDist;
+			search.next[u] = v;
+			search.heap.push_back(make_pair(search.toDest[u], u));
+			push_heap(search.heap.begin(), search.heap.end(), 
+				greater<pair<int, int> >());
+		}
+	}
+}
+
+//------------------------------  findSpurPath  -------------------------------
+// A* search from spur to dest that skips removed vertices and cut edges, 
+// using search.toDest as its (exact, unrestricted) estimate; gives up on paths
+// that cannot be shorter than bound once rootDist is added
+// Preconditions: findDistancesTo() was run for dest; search.removed and 
+// search.cut are set for this spur
+// Postconditions: if a path is found, its vertices from spur to dest are 
+// appended to path, dist holds its distance and true is returned
+bool Graph::findSpurPath(SpurSearch &search, int spur, int dest, int rootDist,
+	int bound, vector<int> &path, int &dist) const
+{
+	// the unrestricted shortest path is the answer if nothing blocks it
+	bool blocked = search.toDest[spur] == INT_MAX || spur == dest ||
+		search.cut[search.next[spur]];
+	for (int v = search.next[spur]; !blocked && v != -1; v = search.next[v])
+	{
+		blocked = search.removed[v];
+	}
+	if (!blocked)
+	{
+		for (int v = spur; v != -1; v = search.next[v])
+		{
+			path.push_back(v);
+		}
+		dist = search.toDest[spur];
+		return true;
+	}
+
+	for (int v = 1; v <= size; v++)
+	{
+		search.dist[v] = INT_MAX;
+		search.visited[v] = false;
+	}
+	search.heap.clear();
+	search.dist[spur] = 0;
+	search.path[spur] = -1;
+	search.heap.push_back(make_pair(search.toDest[spur], spur));
+	while (!search.heap.empty())
+	{
+		pop_heap(search.heap.begin(), search.heap.end(), 
+			greater<pair<int, int> >());
+		int u = search.heap.back().second;
+		search.heap.pop_back();
+		if (search.visited[u])
+		{
+			continue;
+		}
+		search.visited[u] = true;
+		if (u == dest)
+		{
+			size_t first = path.size();
+			for (int v = dest; v != -1; v = search.path[v])
+			{
+				path.push_back(v);
+			}
+			reverse(path.begin() + first, path.end());
+			dist = search.dist[dest];
+			return true;
+		}
+		for (EdgeNode *cur = firstEdge(u); cur != NULL; cur = cur->nextEdge)
+		{
+			int v = cur->adjVertex;
+			if (search.visited[v] || search.removed[v] || 
+				search.toDest[v] == INT_MAX || (u == spur && search.cut[v]))
+			{
+				continue;
+			}
+			long long newDist = (long long)search.dist[u] + cur->weight;
+			long long estimate = newDist + search.toDest[v];
+			if (estimate + rootDist >= bound || newDist >= search.dist[v])
+			{
+				continue;
+			}
+			search.dist[v] = (int)newDist;
+			search.path[v] = u;
+			search.heap.push_back(make_pair((int)estimate, v));
+			push_heap(search.heap.begin(), search.heap.end(), 
+				greater<pair<int, int> >());
+		}
+	}
+	return false;
+}
+
+//------------------------------  isLonger  -----------------------------------
+// Orders the candidate routes of findRoutes() as a min-heap
+// Preconditions: none
+// Postconditions: returns true if route is longer than other
+bool Graph::isLonger(const Route &route, const Route &other)
+{
+	return route.dist > other.dist;
+}
+
+//------------------------------  edgeWeight  ---------------------------------
+// Preconditions: src and dest are subscripts within the graph's size limits
+// Postconditions: returns the lowest weight of an edge from src to dest, or 
+// INT_MAX if there is none
+int Graph::edgeWeight(int src, int dest) const
+{
+	int weight = INT_MAX;
+	for (EdgeNode *cur = firstEdge(src); cur != NULL; cur = cur->nextEdge)
+	{
+		if (cur->adjVertex == dest && cur->weight < weight)
+		{
+			weight = cur->weight;
+		}
+	}
+	return weight;
+}
+
+//------------------------------  sharedEdges  --------------------------------
+// Preconditions: none
+// Postconditions: returns the number of edges of path that are also edges of
+// other
+int Graph::sharedEdges(const vector<int> &path, const vector<int> &other)
+{
+	int shared = 0;
+	for (size_t i = 0; i + 1 < path.size(); i++)
+	{
+		for (size_t j = 0; j + 1 < other.size(); j++)
+		{
+			if (path[i] == other[j] && path[i + 1] == other[j + 1])
+			{
+				shared++;
+				break;
+			}
+		}
+	}
+	return shared;
+}
+
+//------------------------------  computeBFSOrder  ----------------------------
+// Numbers the vertices in breadth-first order, starting a new search from the
+// lowest unvisited subscript; with byDegree set, every search starts at the 
+// unvisited vertex of lowest degree, neighbours are queued by increasing 
+// degree and the result is reversed (Reverse Cuthill-McKee)
+// Preconditions: degree[] holds the number of edges of every vertex
+// Postconditions: order[i] is the current subscript of the i-th vertex
+void Graph::computeBFSOrder(int order[], const int degree[], bool byDegree)
+{
+	bool queued[MAX_VERTICES];
+	for (int v = 1; v <= size; v++)
+	{
+		queued[v] = false;
+	}
+	int head = 1, tail = 1;                  // order[] doubles as the queue
+	while (tail <= size)
+	{
+		int start = 0;
+		for (int v = 1; v <= size; v++)
+		{
+			if (!queued[v] && (start == 0 || 
+				(byDegree && degree[v] < degree[start])))
+			{
+				start = v;
+			}
+		}
+		queued[start] = true;
+		order[tail++] = start;
+		while (head < tail)
+		{
+			int first = tail;
+			for (EdgeNode *cur = firstEdge(order[head]); cur != NULL;
+				cur = cur->nextEdge)
+			{
+				if (!queued[cur->adjVertex])
+				{
+					queued[cur->adjVertex] = true;
+					order[tail++] = cur->adjVertex;
+				}
+			}
+			head++;
+			// insertion sort of the newly queued neighbours by degree
+			for (int i = first + 1; byDegree && i < tail; i++)
+			{
+				int v = order[i], j = i;
+				for (; j > first && degree[order[j - 1]] > degree[v]; j--)
+				{
+					order[j] = order[j - 1];
+				}
+				order[j] = v;
+			}
+		}
+	}
+	for (int i = 1, j = size; byDegree && i < j; i++, j--)
+	{
+		int temp = order[i];
+		order[i] = order[j];
+		order[j] = temp;
+	}
+}
+
+//------------------------------  computeDegreeOrder  -------------------------
+// Numbers the vertices by decreasing degree (ties keep their order)
+// Preconditions: degree[] holds the number of edges of every vertex
+// Postconditions: order[i] is the current subscript of the i-th vertex
+void Graph::computeDegreeOrder(int order[], const int degree[])
+{
+	for (int i = 1; i <= size; i++)
+	{
+		int j = i;
+		for (; j > 1 && degree[order[j - 1]] < degree[i]; j--)
+		{
+			order[j] = order[j - 1];
+		}
+		order[j] = i;
+	}
+}
+
+//------------------------------  applyOrder  ---------------------------------
+// Moves every vertex to its position in order[] and renumbers the edges
+// Preconditions: order[1..size] is a permutation of 1..size
+// Postconditions: vertex order[i] is stored at subscript i in a new adjacency
+// list; the mapping to the original numbering is updated
+void Graph::applyOrder(const int order[])
+{
+	shared_ptr<AdjList> moved = make_shared<AdjList>();
+	int newIndex[MAX_VERTICES];
+	for (int i = 1; i <= size; i++)
+	{
+		newIndex[order[i]] = i;
+	}
+	for (int i = 1; i <= size; i++)
+	{
+		// copy the edges, kept sorted by their new adjVertex; the old lists 
+		// may still be shared by other copies of the graph
+		VertexNode &vertex = moved->vertices[i];
+		vertex.data = adj->vertices[order[i]].data;
+		if (firstEdge(order[i]) != NULL)
+		{
+			vertex.edges = make_shared<EdgeList>();
+		}
+		for (EdgeNode *cur = firstEdge(order[i]); cur != NULL;
+			cur = cur->nextEdge)
+		{
+			EdgeNode *edgeN = new EdgeNode;
+			edgeN->adjVertex = newIndex[cur->adjVertex];
+			edgeN->weight = cur->weight;
+			EdgeNode **link = &vertex.edges->head;
+			while (*link != NULL && (*link)->adjVertex < edgeN->adjVertex)
+			{
+				link = &(*link)->nextEdge;
+			}
+			edgeN->nextEdge = *link;
+			*link = edgeN;
+		}
+		moved->toOriginal[i] = adj->toOriginal[order[i]];
+		moved->toInternal[moved->toOriginal[i]] = i;
+	}
+	adj = moved;
+}
+
 //-----------------------------  displayAll  ---------------------------------
 // Outputs the contents of the Grapht o the console in the table 
 // format, required by the assignment specs (source followed by destination, 
@@ -263,24 +987,30 @@ void Graph::findShortestPath()
 // get output to to console.
 void Graph::displayAll()
 {
+	if (!paths)
+	{
+		return;
+	}
 	cout << "Description\t\t\t" << "From\t" << "To\t" <<
 		"Distance   " << "Path" << endl;
-	for (int src = 1; src <= size; src++)
+	for (int from = 1; from <= size; from++)
 	{
-		cout << *this->vertices[src].data << endl;
-		for (int dest = 1; dest <= size; dest++)
+		int src = adj->toInternal[from];
+		cout << *adj->vertices[src].data << endl;
+		for (int to = 1; to <= size; to++)
 		{
-			if (T[src][dest].path != -1)
+			int dest = adj->toInternal[to];
+			if (paths->T[src][dest].path != -1)
 			{
 				cout << "\t\t\t\t";
-				cout << src << "\t" << dest << "\t";
-				if (T[src][dest].dist == INT_MAX || T[src][dest].dist < 0)
+				cout << from << "\t" << to << "\t";
+				if (paths->T[src][dest].dist == INT_MAX || paths->T[src][dest].dist < 0)
 				{
 					cout << "--" << endl;
 				}
 				else
 				{
-					cout << T[src][dest].dist << "\t   ";
+					cout << paths->T[src][dest].dist << "\t   ";
 					displayPath(src, dest);
 					cout << endl;
 				}
@@ -300,20 +1030,22 @@ void Graph::displayAll()
 // displayPath and dispalyPathWithDescriptions
 void Graph::display(int src, int dest)
 {
-	if (src < 1 || src > size || dest < 1 || dest > size)
+	if (src < 1 || src > size || dest < 1 || dest > size || !paths)
 	{
 		return;
 	}
 	else
 	{
 		cout << src << "\t" << dest << "\t";
-		if (T[src][dest].dist == INT_MAX || T[src][dest].dist < 0)
+		src = adj->toInternal[src];
+		dest = adj->toInternal[dest];
+		if (paths->T[src][dest].dist == INT_MAX || paths->T[src][dest].dist < 0)
 		{
 			cout << "--" << endl;
 		}
 		else
 		{
-			cout << T[src][dest].dist << "\t   ";
+			cout << paths->T[src][dest].dist << "\t   ";
 			displayPath(src, dest);
 			cout << endl;
 			displayPathWithDescriptions(src, dest);
@@ -328,14 +1060,14 @@ void Graph::display(int src, int dest)
 // on the console
 void Graph::displayPathWithDescriptions(int src, int dest)
 {
-	if (T[src][dest].path == -1)
+	if (paths->T[src][dest].path == -1)
 	{
-		cout << *this->vertices[src].data << "  " << endl;
+		cout << *adj->vertices[src].data << "  " << endl;
 	}
 	else
 	{
-		displayPathWithDescriptions(src, T[src][dest].path);
-		cout << *this->vertices[dest].data << "  " << endl;
+		displayPathWithDescriptions(src, paths->T[src][dest].path);
+		cout << *adj->vertices[dest].data << "  " << endl;
 	}
 }
 
@@ -345,36 +1077,27 @@ void Graph::displayPathWithDescriptions(int src, int dest)
 // Postconditions: the Graph's shortest path  gets displayed on the console
 void Graph::displayPath(int src, int dest)
 {
-	if (T[src][dest].path == -1)
+	if (paths->T[src][dest].path == -1)
 	{
-		cout << src << "  ";
+		cout << adj->toOriginal[src] << "  ";
 	}
 	else
 	{
-		displayPath(src, T[src][dest].path);
-		cout << dest << "  ";
+		displayPath(src, paths->T[src][dest].path);
+		cout << adj->toOriginal[dest] << "  ";
 	}
 }
 
 //-------------------------------- clear -------------------------------------
 // Empties the Graph
 // Preconditions: none
-// Postconditions: the Graph's memory is appropriately deallocated
+// Postconditions: the Graph's references to its adjacency list and table are
+// dropped; memory no other copy of the graph uses is deallocated
 void Graph::clear()
 {
-	for (int src = 1; src < size; src++)
-	{
-		EdgeNode *temp = new EdgeNode;
-		temp = this->vertices[src].edgeHead;
-		while (temp != NULL)
-		{
-			temp = this->vertices[src].edgeHead->nextEdge;
-			this->vertices[src].edgeHead = NULL;
-			this->vertices[src].edgeHead = temp;
-		}
-		delete temp;
-		temp = NULL;
-	}
+	size = 0;
+	adj.reset();
+	paths.reset();
 }
 
 //---------------------------- Destructor -------------------------------------
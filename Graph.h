@@ -10,52 +10,98 @@
 //	--displays the cost and path from every vertex to every other vertex in a 
 //	  specific format
 //	--can output one particular path in detail 
-//	--reads data from a file
+//	--reads data from a file (or any other input stream)
 //	--inserts an edge into a graph, replacing the previous edge that existed 
 //	  between the two vertices
+//	--can relabel its vertices (BFS, Reverse Cuthill-McKee or degree order)
+//	  while keeping the original vertex numbers for all input and output;
+//	  within the 100 vertex limit this does not speed up findShortestPath()
+//	--copies share the vertex data, edge lists and path table with the 
+//	  original until one of them changes, so copying a graph is O(1)
+//	--finds the k shortest loopless paths between two vertices (Yen's 
+//	  algorithm), or alternative routes that share few edges with each other
 // ASSUMPTIONS:
 //	--text file to be read by the program contains properly formatted info
-//	  the graph can contain no more than 100 vertices
+//	  the graph can contain no more than 100 vertices; reading stops at the 
+//	  first malformed line and leaves the stream in a failed state
 //	--user is responsible to call findShortestPath() in order to "update"
 //	  the look of the grapth's output, if the insertEdge() or removeEdge()
 //	  were called after the original shortest path search occurred.
-//	--the graph contains no negative values of weights or vertices
+//	--the graph contains no negative values of weights or vertices; an edge
+//	  with a negative weight is ignored
+//	--a second edge between the same two vertices replaces the first, also
+//	  in the input file, where the last line wins
+//	--distances that cannot be reached stay INT_MAX in the table
 //-----------------------------------------------------------------------------
 
 #pragma once
 #include <iostream>
+#include <memory>
+#include <vector>
 #include "GraphData.h"
 
 class Graph 
 {                            
 public:
 
+	// orderings that reorderVertices() can apply to the vertices
+	enum VertexOrder {
+		ORIGINAL_ORDER,			// numbering as read from the input file
+		BFS_ORDER,				// breadth-first search order
+		RCM_ORDER,				// Reverse Cuthill-McKee order
+		DEGREE_ORDER			// decreasing number of incident edges
+	};
+
 	//-------------------------------Default Constructor-----------------------
 	// Preconditions:none
 	// Postconditions: a new Graph object is created with size '0'; the 
-	// adjecency list and a table get initialized;
+	// adjecency list and a table get allocated when the graph is built and 
+	// searched
 	Graph();
 
 	//--------------------------------Copy Constructor-------------------------
-	// makes a deep copy of a graph
+	// makes a copy of a graph that shares the source's adjacency list and 
+	// table until either graph changes
 	// Preconditions: srcGraph must be allocated in memory
-	// Postconditions: srcGrapth is copied into this graph 9as well as its 
+	// Postconditions: srcGrapth is copied into this graph (as well as its 
 	// table)
 	Graph(const Graph &);
 
+	//--------------------------------Move Constructor-------------------------
+	// takes over the adjacency list and table of a graph that is going away
+	// Preconditions: srcGraph must be allocated in memory
+	// Postconditions: this graph holds srcGraph's contents; srcGraph is empty
+	Graph(Graph &&) noexcept;
+
+	//----------------------------------  =  ----------------------------------
+	// assigns srcGraph to *this, sharing its adjacency list and table until 
+	// either graph changes
+	// Preconditions: srcGraph must be allocated in memory
+	// Postconditions: srcGraph is copied into *this
+	Graph & operator=(const Graph &);
+
+	//----------------------------------  =  ----------------------------------
+	// moves the contents of a graph that is going away into *this
+	// Preconditions: srcGraph must be allocated in memory
+	// Postconditions: *this holds srcGraph's contents; srcGraph is empty
+	Graph & operator=(Graph &&) noexcept;
+
 	//-------------------------------- buildGraph -----------------------------
-	// Builds a graph by reading data from an ifstream
+	// Builds a graph by reading data from an istream
 	// Preconditions: infile has been successfully opened and the file contains
 	// properly formated data (according to the program specs)
-	// Postconditions: One graph is read from infile and stored in the object
-	void buildGraph(ifstream &);
+	// Postconditions: One graph is read from infile and stored in the object;
+	// if the vertex count is out of range the graph is left empty and infile
+	// fails, other malformed data ends the list of edges
+	void buildGraph(istream &);
 
 	//-------------------------------- insertEdge -----------------------------
 	// Inserts an edge into a graph
 	// Preconditions: Grapth object is allocated in memory; src is within the
 	// size limits of a current object
-	// Postconditions: an edge is inserted into a graph if its source is within
-	// size limits, replacing any previous edge between the vertices
+	// Postconditions: an edge is inserted into a graph if its source and 
+	// destination are within size limits and its weight is not negative, 
+	// replacing any previous edge between the vertices
 	void insertEdge(int , int ,int );
 
 	//------------------------------  removeEdge  -----------------------------
@@ -73,6 +119,53 @@ public:
 	// their weights
 	void findShortestPath();
 
+	//-----------------------------  getDistance  -----------------------------
+	// Preconditions: findShortestPath() has been called since the graph last
+	// changed
+	// Postconditions: returns the distance of the shortest path from src to 
+	// dest, INT_MAX if dest cannot be reached, or -1 if src or dest is not 
+	// within the graph's size limits or no search was made
+	int getDistance(int, int) const;
+
+	//-----------------------------  getPath  ---------------------------------
+	// Preconditions: findShortestPath() has been called since the graph last
+	// changed
+	// Postconditions: path holds the vertex numbers of the shortest path from
+	// src to dest (empty if there is none); returns the number of vertices
+	int getPath(int, int, vector<int> &) const;
+
+	//---------------------------- reorderVertices  ---------------------------
+	// Relabels the vertices internally so that vertices that are relaxed 
+	// together by findShortestPath() are stored close together in memory.
+	// Within MAX_VERTICES this does not make findShortestPath() faster.
+	// Preconditions: the graph object is allocated and properly initialized
+	// Postconditions: the adjacency list and vertex data are permuted in the 
+	// requested order; all methods keep taking and displaying the original 
+	// vertex numbers. The table is dropped, as before the first search, so
+	// findShortestPath() must be called again before displaying or querying.
+	void reorderVertices(VertexOrder);
+
+	//------------------------- findKShortestPaths  --------------------------
+	// Finds up to k loopless paths from src to dest in increasing order of 
+	// distance (Yen's algorithm)
+	// Preconditions: the graph object is allocated and properly initialized
+	// Postconditions: routes holds the paths found as vertex numbers from src
+	// to dest, and dists their distances; returns the number of paths found
+	// (0 if src or dest is not within the graph's size limits)
+	int findKShortestPaths(int, int, int, vector<vector<int> > &, 
+		vector<int> &) const;
+
+	//------------------------- findAlternativeRoutes  -----------------------
+	// Finds up to k short loopless paths from src to dest that differ from 
+	// each other: a path is skipped if more than maxOverlap (0.0 to 1.0) of 
+	// its edges are also used by a shorter route that was kept. At most k 
+	// times the graph's size paths are examined.
+	// Preconditions: the graph object is allocated and properly initialized
+	// Postconditions: routes holds the routes found as vertex numbers from 
+	// src to dest, and dists their distances; returns the number of routes
+	int findAlternativeRoutes(int, int, int, double, 
+		vector<vector<int> > &, vector<int> &) const;
+
 	//-----------------------------  displayAll  ------------------------------
 	// Outputs the contents of the Grapht o the console in the table 
 	// format, required by the assignment specs(source followed by destination, 
@@ -96,7 +189,8 @@ public:
 	//-------------------------------- clear ----------------------------------
 	// Empties the Graph
 	// Preconditions: none
-	// Postconditions: the Graph's memory is appropriately deallocated
+	// Postconditions: the Graph's references to its adjacency list and table
+	// are dropped; memory no other copy of the graph uses is deallocated
 	void clear();
 
 	//---------------------------- Destructor ---------------------------------
@@ -115,13 +209,29 @@ private:
 		EdgeNode *nextEdge;
 	};
 
+	// edges leaving one vertex; copies of a graph share a list until one of
+	// them inserts or removes an edge there
+	struct EdgeList {
+		EdgeNode *head;			// head of the list, sorted by adjVertex
+		EdgeList();
+		EdgeList(const EdgeList &);
+		~EdgeList();
+		EdgeList & operator=(const EdgeList &) = delete;
+	};
+
 	struct VertexNode {
-		EdgeNode *edgeHead;		// head of the list of edges
-		GraphData *data;		// store vertex data here
+		shared_ptr<EdgeList> edges;			// NULL if no edges
+		shared_ptr<const GraphData> data;	// store vertex data here
 	};
 
-	// array of VertexNodes
-	VertexNode vertices[MAX_VERTICES];
+	// array of VertexNodes and the numbering of the vertices; copies of a 
+	// graph share it until one of them changes
+	struct AdjList {
+		VertexNode vertices[MAX_VERTICES];
+		int toInternal[MAX_VERTICES];	// original vertex number -> subscript
+		int toOriginal[MAX_VERTICES];	// subscript -> original vertex number
+		AdjList();
+	};
 	
 	// table of information for Dijkstra's algorithm
 	struct Table {
@@ -129,28 +239,143 @@ private:
 		int dist;				// shortest known distance from source
 		int path;				// previous vertex in path of min dist
 	};
+
+	// stores visited, distance, path - two dimensional in order to solve for
+	// all sources
+	struct PathTable {
+		Table T[MAX_VERTICES][MAX_VERTICES];
+	};
+
+	// a path (as subscripts) and its distance, for the k shortest paths
+	struct Route {
+		int dist;
+		vector<int> path;
+	};
+
+	// scratch space of one k shortest paths query; allocated once and reused
+	// by all of its spur searches
+	struct SpurSearch {
+		int dist[MAX_VERTICES];		// shortest known distance from spur
+		int path[MAX_VERTICES];		// previous vertex in path of min dist
+		bool visited[MAX_VERTICES];	// whether vertex has been visited
+		bool removed[MAX_VERTICES];	// vertex is on the root path
+		bool cut[MAX_VERTICES];		// edge from spur to vertex is removed
+		int toDest[MAX_VERTICES];	// distance to dest with nothing removed,
+									// INT_MAX if dest cannot be reached
+		int next[MAX_VERTICES];		// next vertex on that path, -1 at dest
+		int inStart[MAX_VERTICES + 1];	// edges into v are in[inStart[v]] 
+									// up to in[inStart[v + 1]]
+		vector<pair<int, int> > in;	// (source, weight), grouped by dest
+		vector<pair<int, int> > heap;	// (estimate, vertex), min on top
+		vector<int> spurRoute;		// candidate path being built
+	};
+
 	int size;					// number of vertices in the graph
-	Table T[MAX_VERTICES][MAX_VERTICES];
-								// stores visited, distance, path -
-								// two dimensional in order to solve
-								// for all sources
-
-	//------------------------------  initializeAdjList  ----------------------
-	// Initializes the Graph object (represented by an adjacency list) to the
-	// default values
+	shared_ptr<AdjList> adj;	// NULL until the graph is built
+	shared_ptr<PathTable> paths;	// NULL until findShortestPath() runs
+
+	//------------------------------  isShared  -------------------------------
+	// Tells whether a block is also referenced by another copy of the graph
+	// Preconditions: none
+	// Postconditions: returns false if useCount says this graph is the 
+	// block's only owner
+	static bool isShared(long);
+
+	//------------------------------  ownAdjList  -----------------------------
+	// Gives this graph its own vertex array before it gets changed; the edge
+	// lists and vertex data stay shared
 	// Preconditions: the Graph object must be allocated
-	// Postconditions: the Graph's adjacency list is properly initialized to 
-	// default values (edgeHead of a linked list at vertex[i] is initialiazed 
-	// to NULL). 
-	void initializeAdjList();
+	// Postconditions: the adjacency list is referenced by this graph only
+	AdjList & ownAdjList();
+
+	//------------------------------  ownEdges  -------------------------------
+	// Gives this graph its own copy of the edges leaving vertex v before they
+	// get changed
+	// Preconditions: v is a subscript within the graph's size limits
+	// Postconditions: the list of edges of v is referenced by this graph only
+	EdgeList & ownEdges(int);
+
+	//------------------------------  firstEdge  ------------------------------
+	// Preconditions: v is a subscript within the graph's size limits
+	// Postconditions: returns the head of the list of edges leaving v, or NULL
+	EdgeNode * firstEdge(int) const;
+
+	//------------------------------  edgeWeight  -----------------------------
+	// Preconditions: src and dest are subscripts within the graph's size 
+	// limits
+	// Postconditions: returns the lowest weight of an edge from src to dest,
+	// or INT_MAX if there is none
+	int edgeWeight(int, int) const;
+
+	//------------------------------  findRoutes  -----------------------------
+	// Runs Yen's algorithm from src to dest, examining up to the given number
+	// of shortest paths and keeping the ones whose overlap with the routes 
+	// kept before is at most maxOverlap, until wanted routes are kept
+	// Preconditions: the graph object is allocated and properly initialized
+	// Postconditions: routes and dists hold the routes kept, with original 
+	// vertex numbers; returns the number of routes kept
+	int findRoutes(int, int, int, int, double, vector<vector<int> > &, 
+		vector<int> &) const;
+
+	//------------------------------  findDistancesTo  ------------------------
+	// Dijkstra's algorithm over the reversed edges, from dest
+	// Preconditions: dest is a subscript within the graph's size limits
+	// Postconditions: search.toDest and search.next describe the shortest 
+	// paths from every vertex to dest
+	void findDistancesTo(SpurSearch &, int) const;
+
+	//------------------------------  findSpurPath  ---------------------------
+	// A* search from spur to dest that skips removed vertices and cut edges,
+	// using search.toDest as its (exact, unrestricted) estimate; gives up on 
+	// paths that cannot be shorter than bound once rootDist is added
+	// Preconditions: findDistancesTo() was run for dest; search.removed and
+	// search.cut are set for this spur
+	// Postconditions: if a path is found, its vertices from spur to dest are 
+	// appended to path, dist holds its distance and true is returned
+	bool findSpurPath(SpurSearch &, int, int, int, int, vector<int> &, 
+		int &) const;
+
+	//------------------------------  isLonger  -------------------------------
+	// Orders the candidate routes of findRoutes() as a min-heap
+	// Preconditions: none
+	// Postconditions: returns true if route is longer than other
+	static bool isLonger(const Route &, const Route &);
+
+	//------------------------------  sharedEdges  ----------------------------
+	// Preconditions: none
+	// Postconditions: returns the number of edges of path that are also 
+	// edges of other
+	static int sharedEdges(const vector<int> &, const vector<int> &);
 
 	//------------------------------  initializeTable  ------------------------
 	// Initializes the Table (2D array) to default values
 	// Preconditions: the Graph object must be allocated
-	// Postconditions: the Graph's Table is properly initialized to default 
-	// values
+	// Postconditions: the Graph's Table is referenced by this graph only and 
+	// is properly initialized to default values
 	void initializeTable();
 
+	//------------------------------  computeBFSOrder  ------------------------
+	// Numbers the vertices in breadth-first order, starting a new search from 
+	// the lowest unvisited subscript; with byDegree set, every search starts 
+	// at the unvisited vertex of lowest degree, neighbours are queued by 
+	// increasing degree and the result is reversed (Reverse Cuthill-McKee)
+	// Preconditions: degree[] holds the number of edges of every vertex
+	// Postconditions: order[i] is the current subscript of the i-th vertex
+	void computeBFSOrder(int [], const int [], bool);
+
+	//------------------------------  computeDegreeOrder  ---------------------
+	// Numbers the vertices by decreasing degree (ties keep their order)
+	// Preconditions: degree[] holds the number of edges of every vertex
+	// Postconditions: order[i] is the current subscript of the i-th vertex
+	void computeDegreeOrder(int [], const int []);
+
+	//------------------------------  applyOrder  -----------------------------
+	// Moves every vertex to its position in order[] and renumbers the edges
+	// Preconditions: order[1..size] is a permutation of 1..size
+	// Postconditions: vertex order[i] is stored at subscript i in a new 
+	// adjacency list; the mapping to the original numbering is updated
+	void applyOrder(const int []);
+
 	//-------------------------------- displayPath  ---------------------------
 	// Outputs the numerical description for the Graph's path to the console
 	// Preconditions: Graph object is allocated in memory
@@ -0,0 +1,337 @@
+//---------------------------------------------------------------------------
+// GraphTest.cpp
+// Randomized tests for the Graph class.
+//---------------------------------------------------------------------------
+// Random graphs (with duplicate edges and removals of missing edges) are
+// cross-checked against a Bellman-Ford reference in every vertex order, for
+// the table, its paths, copies, the k shortest paths (against every loopless
+// path for small graphs) and the alternative routes (which may overlap each
+// other by at most MAX_OVERLAP); random bytes are fed into buildGraph. A 
+// fixed seed makes every run the same.
+//
+// LLVMFuzzerTestOneInput is a libFuzzer entry point; when this file is 
+// built with FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION defined (and 
+// -fsanitize=fuzzer), main is left out and libFuzzer drives it instead.
+//
+// Assumptions:
+//   -- built as its own program, together with Graph.cpp and GraphData.cpp
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Graph.h"
+using namespace std;
+
+const int TEST_VERTICES = 16;     // largest random graph of the self-test
+const int NO_EDGE = -1;
+const int ENUMERATED_VERTICES = 7; // graphs this small get every path listed
+const int K_PATHS = 10;            // paths asked for per k shortest query
+const int K_ROUTES = 3;            // routes asked for per alternative query
+const double MAX_OVERLAP = 0.5;    // overlap allowed between alternatives
+
+// edge weights of a random graph, NO_EDGE where there is none
+typedef int Weights[TEST_VERTICES + 1][TEST_VERTICES + 1];
+
+//-------------------------- bellmanFord ------------------------------------
+// Reference distances from src, computed without the Graph class
+// Preconditions:   weight holds the edges of a graph with n vertices
+// Postconditions:  dist[v] is the shortest distance from src to v, or 
+//                  INT_MAX if v cannot be reached
+void bellmanFord(int n, const Weights weight, int src, int dist[]) {
+   for (int v = 1; v <= n; v++)
+      dist[v] = INT_MAX;
+   dist[src] = 0;
+   for (int pass = 1; pass < n; pass++) {
+      for (int u = 1; u <= n; u++) {
+         if (dist[u] == INT_MAX)
+            continue;
+         for (int v = 1; v <= n; v++) {
+            if (weight[u][v] != NO_EDGE && dist[u] + weight[u][v] < dist[v])
+               dist[v] = dist[u] + weight[u][v];
+         }
+      }
+   }
+}
+
+//-------------------------- isValidPath ------------------------------------
+// Checks that path is a loopless path from src to dest of length dist
+// Preconditions:   weight holds the edges of a graph with n vertices
+// Postconditions:  returns true if the path is valid
+bool isValidPath(int n, const Weights weight, const vector<int> &path, 
+                 int src, int dest, int dist) {
+   if (path.empty() || path.front() != src || path.back() != dest)
+      return false;
+   int sum = 0;
+   for (size_t i = 0; i < path.size(); i++) {
+      if (path[i] < 1 || path[i] > n)
+         return false;
+      for (size_t j = 0; j < i; j++) {
+         if (path[j] == path[i])
+            return false;
+      }
+      if (i > 0) {
+         if (weight[path[i - 1]][path[i]] == NO_EDGE)
+            return false;
+         sum += weight[path[i - 1]][path[i]];
+      }
+   }
+   return sum == dist;
+}
+
+//-------------------------- listPathDistances -----------------------------
+// Reference for the k shortest paths: the distance of every loopless path 
+// from u to dest, found by depth-first search
+// Preconditions:   weight holds the edges of a graph with n vertices; 
+//                  onPath marks the vertices of the path so far, ending at u
+// Postconditions:  the distances are appended to found, unsorted
+void listPathDistances(int n, const Weights weight, int u, int dest, 
+                       int dist, bool onPath[], vector<int> &found) {
+   if (u == dest) {
+      found.push_back(dist);
+      return;
+   }
+   for (int v = 1; v <= n; v++) {
+      if (weight[u][v] != NO_EDGE && !onPath[v]) {
+         onPath[v] = true;
+         listPathDistances(n, weight, v, dest, dist + weight[u][v], onPath, 
+                           found);
+         onPath[v] = false;
+      }
+   }
+}
+
+//-------------------------- sharedEdgeCount --------------------------------
+// Preconditions:   none
+// Postconditions:  returns the number of edges of path also used by other
+int sharedEdgeCount(const vector<int> &path, const vector<int> &other) {
+   int shared = 0;
+   for (size_t i = 0; i + 1 < path.size(); i++) {
+      for (size_t j = 0; j + 1 < other.size(); j++) {
+         if (path[i] == other[j] && path[i + 1] == other[j + 1]) {
+            shared++;
+            break;
+         }
+      }
+   }
+   return shared;
+}
+
+//-------------------------- checkRoutes ------------------------------------
+// Checks the k shortest paths and the alternative routes from src to dest;
+// for small graphs the distances must be exactly the shortest ones listed
+// by depth-first search
+// Preconditions:   G holds the graph described by weight, with n vertices;
+//                  shortest is the reference distance from src to dest
+// Postconditions:  returns true if both queries agree with the reference
+bool checkRoutes(const Graph &G, int n, const Weights weight, int src, 
+                 int dest, int shortest) {
+   vector<vector<int> > routes;
+   vector<int> dists;
+   int count = G.findKShortestPaths(src, dest, K_PATHS, routes, dists);
+   if (shortest == INT_MAX ? count != 0 : count < 1 || dists[0] != shortest)
+      return false;
+   for (int k = 0; k < count; k++) {
+      if (!isValidPath(n, weight, routes[k], src, dest, dists[k]) ||
+          (k > 0 && dists[k] < dists[k - 1]))
+         return false;
+      for (int j = 0; j < k; j++) {
+         if (routes[j] == routes[k])
+            return false;
+      }
+   }
+   if (n <= ENUMERATED_VERTICES) {
+      vector<int> all;
+      bool onPath[TEST_VERTICES + 1] = { false };
+      onPath[src] = true;
+      listPathDistances(n, weight, src, dest, 0, onPath, all);
+      sort(all.begin(), all.end());
+      if (count != (int)min<size_t>(K_PATHS, all.size()))
+         return false;
+      for (int k = 0; k < count; k++) {
+         if (dists[k] != all[k])
+            return false;
+      }
+   }
+
+   count = G.findAlternativeRoutes(src, dest, K_ROUTES, MAX_OVERLAP, routes,
+                                   dists);
+   if (shortest == INT_MAX ? count != 0 : count < 1 || dists[0] != shortest)
+      return false;
+   for (int k = 0; k < count; k++) {
+      if (!isValidPath(n, weight, routes[k], src, dest, dists[k]) ||
+          (k > 0 && dists[k] < dists[k - 1]))
+         return false;
+      int edges = (int)routes[k].size() - 1;
+      for (int j = 0; j < k; j++) {
+         if (sharedEdgeCount(routes[k], routes[j]) > MAX_OVERLAP * edges)
+            return false;
+      }
+   }
+   return true;
+}
+
+//-------------------------- crossCheck -------------------------------------
+// Compares every shortest path engine of G with the reference: the table 
+// and its paths in every vertex order, the k shortest paths and the 
+// alternative routes
+// Preconditions:   G holds the graph described by weight, with n vertices
+// Postconditions:  returns true if all engines agree with the reference;
+//                  G is left in its original vertex order
+bool crossCheck(Graph &G, int n, const Weights weight) {
+   const Graph::VertexOrder orders[] = { Graph::BFS_ORDER, Graph::RCM_ORDER,
+      Graph::DEGREE_ORDER, Graph::ORIGINAL_ORDER };
+   int dist[TEST_VERTICES + 1];
+   vector<int> path;
+   for (int o = 0; o < 4; o++) {
+      G.reorderVertices(orders[o]);
+      G.findShortestPath();
+      for (int src = 1; src <= n; src++) {
+         bellmanFord(n, weight, src, dist);
+         for (int dest = 1; dest <= n; dest++) {
+            if (G.getDistance(src, dest) != dist[dest])
+               return false;
+            G.getPath(src, dest, path);
+            if (dist[dest] == INT_MAX ? !path.empty() :
+                !isValidPath(n, weight, path, src, dest, dist[dest]))
+               return false;
+            // route queries are slow; one reordered numbering is enough
+            if ((orders[o] == Graph::RCM_ORDER || 
+                 orders[o] == Graph::ORIGINAL_ORDER) &&
+                !checkRoutes(G, n, weight, src, dest, dist[dest]))
+               return false;
+         }
+      }
+   }
+   return G.getDistance(0, 1) == -1 && G.getDistance(1, n + 1) == -1;
+}
+
+//-------------------------- randomGraphTest --------------------------------
+// Builds a random graph through buildGraph, changes it with insertEdge and
+// removeEdge, and cross-checks it and an earlier copy with the reference
+// Preconditions:   none
+// Postconditions:  returns true if all engines agree with the reference
+bool randomGraphTest() {
+   int n = 1 + rand() % TEST_VERTICES;
+   Weights weight;
+   for (int u = 1; u <= n; u++) {
+      for (int v = 1; v <= n; v++)
+         weight[u][v] = NO_EDGE;
+   }
+   stringstream text;
+   text << n << endl;
+   for (int v = 1; v <= n; v++)
+      text << "vertex " << v << endl;
+   int edges = rand() % (n * n + 1);
+   for (int e = 0; e < edges; e++) {
+      int src = 1 + rand() % n, dest = 1 + rand() % n, cost = rand() % 50;
+      text << src << " " << dest << " " << cost << endl;
+      weight[src][dest] = cost;                 // later duplicates replace
+   }
+   text << "0 0 0" << endl;
+   Graph G;
+   G.buildGraph(text);
+   if (!text || !crossCheck(G, n, weight))
+      return false;
+
+   Graph before(G);
+   Weights original;
+   for (int u = 1; u <= n; u++) {
+      for (int v = 1; v <= n; v++)
+         original[u][v] = weight[u][v];
+   }
+   G.removeEdge(1, 500);
+   G.insertEdge(n + 1, 1, 1);
+   G.insertEdge(1, 1, -1);
+   for (int op = rand() % (2 * n); op > 0; op--) {
+      int src = 1 + rand() % n, dest = 1 + rand() % n, cost = rand() % 50;
+      if (rand() % 2 == 0) {
+         G.insertEdge(src, dest, cost);
+         weight[src][dest] = cost;
+      } else {
+         G.removeEdge(src, dest);
+         weight[src][dest] = NO_EDGE;
+      }
+   }
+   return crossCheck(G, n, weight) && crossCheck(before, n, original);
+}
+
+//-------------------------- fuzzBuildGraph ---------------------------------
+// Feeds arbitrary bytes into buildGraph and uses every graph read from them
+// Preconditions:   none
+// Postconditions:  the graphs are searched and displayed to a string; 
+//                  returns only if nothing crashed or looped
+void fuzzBuildGraph(const string &bytes) {
+   istringstream input(bytes);
+   ostringstream output;
+   streambuf *console = cout.rdbuf(output.rdbuf());
+   for (;;) {
+      Graph G;
+      G.buildGraph(input);
+      G.findShortestPath();
+      G.displayAll();
+      G.display(1, 2);
+      vector<vector<int> > routes;
+      vector<int> dists;
+      G.findAlternativeRoutes(1, 2, 3, 0.5, routes, dists);
+      if (!input)
+         break;
+   }
+   cout.rdbuf(console);
+}
+
+//-------------------------- LLVMFuzzerTestOneInput -------------------------
+// Fuzz entry point: feeds size arbitrary bytes into buildGraph
+// Preconditions:   data points to size readable bytes
+// Postconditions:  returns 0 (the input is never rejected)
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+   fuzzBuildGraph(string(reinterpret_cast<const char *>(data), size));
+   return 0;
+}
+
+//-------------------------- selfTest ---------------------------------------
+// Runs the randomized tests with a fixed seed
+// Preconditions:   none
+// Postconditions:  returns true if every test passed; the failing test is
+//                  reported to cerr
+bool selfTest() {
+   const char alphabet[] = "0123456789 \n-";
+   srand(343);
+   for (int test = 1; test <= 100; test++) {
+      if (!randomGraphTest()) {
+         cerr << "Self-test failed on random graph " << test << "." << endl;
+         return false;
+      }
+      // any bytes at all, and mostly well-formed numbers with some of 
+      // their bytes replaced by any byte
+      vector<uint8_t> bytes(rand() % 300);
+      for (size_t i = 0; i < bytes.size(); i++)
+         bytes[i] = (uint8_t)(rand() % 256);
+      LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+      for (size_t i = 0; i < bytes.size(); i++) {
+         if (rand() % 8 != 0)
+            bytes[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+      }
+      LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+   }
+   return true;
+}
+
+#ifndef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+//-------------------------- main -------------------------------------------
+// Runs the randomized tests
+// Preconditions:   none
+// Postconditions:  returns 0 if every test passed, 1 otherwise
+int main() {
+   if (!selfTest())
+      return 1;
+   cout << "All Graph tests passed." << endl;
+   return 0;
+}
+#endif
@@ -35,7 +35,7 @@ int main() {
      for(;;){
 		Graph G;
       G.buildGraph(infile1);
-      if (infile1.eof()) 
+      if (!infile1) 
          break;
 	  G.insertEdge(4,2,1);
 	  G.removeEdge(1,500);